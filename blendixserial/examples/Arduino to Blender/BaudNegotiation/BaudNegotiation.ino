@@ -0,0 +1,51 @@
+/*
+  Baud Rate Negotiation - Arduino Sketch
+
+  Arduino to Blender : Negotiating a Faster Baud Rate with Blender.
+  --------------------------------------------
+  At 9600 baud the serial link carries only about 960 bytes per second.
+  This sketch starts at 9600 baud (which every host supports), offers a list
+  of faster rates to Blender, switches to the rate Blender picks and verifies
+  the new link with a probe exchange. If Blender does not answer, or the probe
+  fails, the sketch simply keeps running at 9600 baud.
+
+  Once the rate is settled, it sends coordinate data exactly like the
+  SendingData2Blender example, only much faster.
+
+  If you encounter any errors or bugs while using the blendixserial library 
+  or this code, please feel free to report them. Your feedback is valuable 
+  for improvement!  
+
+  Thank you for your help!
+*/
+
+
+#include "blendixserial.h"
+
+blendixserial blendix;  // Create an instance of blendixserial
+
+// Rates this board can handle, fastest first
+const unsigned long supportedRates[] = { 2000000, 1000000, 500000, 115200 };
+
+void setup() {
+    Serial.begin(9600);  // Always start at the safe rate
+
+    // Try to upgrade; falls back to 9600 automatically if it fails
+    blendix.negotiateBaud(Serial, supportedRates,
+                          sizeof(supportedRates) / sizeof(supportedRates[0]), 9600);
+
+    blendix.setCoordinateType(COORD_TYPE_INT);
+    blendix.setTxSets(1);
+}
+
+void loop() {
+    // Send the potentiometer reading as X coordinate
+    blendix.setCoordinates(1, analogRead(A0), 0, 0);
+
+    uint8_t outputBuffer[50];
+    blendix.getFormattedOutput(outputBuffer, sizeof(outputBuffer));
+
+    Serial.println((char*)outputBuffer);
+
+    delay(10);
+}
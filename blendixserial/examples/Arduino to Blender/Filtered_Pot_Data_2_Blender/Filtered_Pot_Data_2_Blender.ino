@@ -0,0 +1,59 @@
+/*
+  Sending Filtered Potentiometer Data to Blender - Arduino Sketch
+
+  Arduino to Blender : Sending Filtered Potentiometer Data to Blender.
+  --------------------------------------------
+  Analog readings jitter by a few counts even when the potentiometer is not
+  moving, which makes objects in Blender shimmer and wastes serial bandwidth.
+  This sketch samples the potentiometer quickly and lets the blendixserial
+  filter pipeline clean up the signal before it is sent:
+
+    - Oversampling : averages 4 raw readings into one sample
+    - Median       : takes the median of the last 3 samples to reject spikes
+    - Low-pass     : smooths the result with y += (x - y) / 2^2
+    - Decimation   : sends only every 5th filtered sample
+
+  With a 1 ms sample period this gives one frame every 20 ms (50 frames/s).
+  A frame is only sent when isOutputReady() reports a new filtered value.
+
+  If you encounter any errors or bugs while using the blendixserial library 
+  or this code, please feel free to report them. Your feedback is valuable 
+  for improvement!  
+
+  Thank you for your help!
+*/
+
+
+#include "blendixserial.h"
+
+blendixserial serialSender;  // Create blendixserial instance
+
+int potPin = A0;  // Potentiometer connected to A0
+
+void setup() {
+    Serial.begin(9600);  // Start serial communication
+    serialSender.setCoordinateType(COORD_TYPE_INT);
+    serialSender.setTxSets(1);  // Only sending 1 set of coordinates
+
+    // Configure the transmit filter pipeline
+    serialSender.setOversampling(4);
+    serialSender.setMedianWindow(3);
+    serialSender.setLowPass(2);
+    serialSender.setDecimation(5);
+}
+
+void loop() {
+    // Feed every raw reading into the filter as the X coordinate
+    int potValue = analogRead(potPin);
+    serialSender.setCoordinates(1, potValue, 0, 0);
+
+    // Send only when the filter has produced a new output
+    if (serialSender.isOutputReady()) {
+        uint8_t outputBuffer[50];
+        serialSender.getFormattedOutput(outputBuffer, sizeof(outputBuffer));
+
+        Serial.println((char*)outputBuffer);
+    }
+
+    delay(1);
+}
@@ -0,0 +1,101 @@
+/*
+  Size Report - Arduino Sketch
+
+  Minimal sketch used by extras/size_report.sh to measure the flash and RAM
+  cost of each blendixserial feature profile. It calls every function that
+  the enabled subsystems provide, so nothing is optimized away, and skips
+  anything that has been compiled out with the BLENDIX_*_ENABLED switches.
+
+  The library keeps its buffers on the heap, which the compiler's "Global
+  variables" figure does not include. At the end of setup() the sketch prints
+  a "heap=<bytes>" line with the heap in use (AVR only; "heap=?" elsewhere).
+  size_report.sh reads it when given a serial port to upload to.
+*/
+
+
+#include "blendixserial.h"
+
+#if defined(__AVR__)
+extern char __heap_start;
+extern char* __brkval;
+#endif
+
+blendixserial blendix;
+
+// Bytes of heap in use: the library's buffers plus their allocator headers
+long heapUsed() {
+#if defined(__AVR__)
+    return __brkval ? (long)(__brkval - &__heap_start) : 0;
+#else
+    return -1;
+#endif
+}
+
+void setup() {
+    Serial.begin(9600);
+
+#if BLENDIX_BAUD_ENABLED
+    const unsigned long rates[] = { 115200 };
+    blendix.negotiateBaud(Serial, rates, 1, 9600);
+#endif
+
+#if BLENDIX_TX_ENABLED
+    blendix.setTxSets(1);
+#endif
+#if BLENDIX_RX_ENABLED
+    blendix.setRxSets(1);
+#endif
+#if BLENDIX_FILTER_ENABLED
+    blendix.setOversampling(4);
+    blendix.setMedianWindow(3);
+    blendix.setLowPass(2);
+    blendix.setDecimation(2);
+#endif
+
+    long heap = heapUsed();
+    Serial.print("heap=");
+    if (heap < 0) {
+        Serial.println('?');
+    } else {
+        Serial.println(heap);
+    }
+}
+
+void loop() {
+#if BLENDIX_TX_ENABLED
+    int raw = analogRead(A0);
+#if BLENDIX_FLOAT_ENABLED
+    blendix.setCoordinateType((raw & 1) ? COORD_TYPE_FLOAT : COORD_TYPE_INT);
+    blendix.setCoordinates(1, raw / 10.0f, 0.0f, 0.0f);
+#endif
+    blendix.setCoordinates(1, raw, 0, 0);
+#if BLENDIX_TEXT_ENABLED
+    blendix.setText("size");
+#endif
+
+    uint8_t outputBuffer[50];
+    blendix.getFormattedOutput(outputBuffer, sizeof(outputBuffer));
+    Serial.println((char*)outputBuffer);
+#endif
+
+#if BLENDIX_RX_ENABLED
+    static char inputBuffer[50];
+    static size_t length = 0;
+
+    while (Serial.available() && length < sizeof(inputBuffer) - 1) {
+        inputBuffer[length++] = Serial.read();
+        inputBuffer[length] = '\0';
+
+        if (blendix.parseReceivedData(inputBuffer)) {
+            float x, y, z;
+            if (blendix.getReceivedCoordinates(0, x, y, z)) {
+                Serial.println((int)x);  // Avoid linking Print::printFloat
+            }
+            length = 0;
+        }
+    }
+    if (length >= sizeof(inputBuffer) - 1) {
+        length = 0;
+    }
+#endif
+}
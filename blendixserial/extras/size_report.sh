@@ -0,0 +1,78 @@
+#!/bin/sh
+#
+# Builds extras/SizeReport once per blendixserial feature profile and prints
+# its flash and RAM usage.
+#
+# Usage: extras/size_report.sh [fqbn [port]]
+#   fqbn defaults to arduino:avr:uno (e.g. ATTinyCore:avr:attinyx5 for an ATtiny85)
+#   port (e.g. /dev/ttyACM0) uploads each profile to a connected board and reads
+#        the heap it uses; without it the Heap column shows "-"
+#
+# Columns:
+#   Flash   program storage, from arduino-cli
+#   Static  global/static RAM, from arduino-cli ("Global variables use")
+#   Heap    RAM the library allocates at runtime, reported by the sketch (AVR only)
+# Total RAM cost is Static + Heap (plus stack).
+#
+# Requires arduino-cli with the core for the selected board installed.
+
+FQBN=${1:-arduino:avr:uno}
+PORT=$2
+LIB_DIR=$(cd "$(dirname "$0")/.." && pwd)
+SKETCH="$LIB_DIR/extras/SizeReport"
+BUILD_ROOT=$(mktemp -d)
+trap 'rm -rf "$BUILD_ROOT"' EXIT
+
+# Uploads the build in $1 and prints the heap figure the sketch reports
+read_heap() {
+  arduino-cli upload -p "$PORT" --fqbn "$FQBN" --input-dir "$1" </dev/null >/dev/null 2>&1 || return 1
+  stty -F "$PORT" 9600 raw -echo 2>/dev/null || return 1
+  # Opening the port resets most boards, so the sketch prints its heap line again
+  timeout 10 grep -a -m1 '^heap=' "$PORT" | sed 's/^heap=//' | tr -d '\r'
+}
+
+# name|compiler flags
+PROFILES="
+full|
+no-filter|-DBLENDIX_FILTER_ENABLED=0
+no-baud|-DBLENDIX_BAUD_ENABLED=0
+no-text|-DBLENDIX_TEXT_ENABLED=0
+no-float|-DBLENDIX_FLOAT_ENABLED=0
+tx-only|-DBLENDIX_RX_ENABLED=0
+tx-int-only|-DBLENDIX_RX_ENABLED=0 -DBLENDIX_FLOAT_ENABLED=0 -DBLENDIX_TEXT_ENABLED=0 -DBLENDIX_FILTER_ENABLED=0 -DBLENDIX_BAUD_ENABLED=0
+rx-only|-DBLENDIX_TX_ENABLED=0
+"
+
+printf "Board: %s\n\n" "$FQBN"
+printf "%-14s %8s %8s %8s\n" "Profile" "Flash" "Static" "Heap"
+
+status=0
+while IFS='|' read -r name flags; do
+  [ -z "$name" ] && continue
+
+  build="$BUILD_ROOT/$name"
+  output=$(arduino-cli compile --clean --fqbn "$FQBN" --library "$LIB_DIR" \
+    --build-path "$build" \
+    --build-property "compiler.cpp.extra_flags=$flags" \
+    --build-property "compiler.c.extra_flags=$flags" \
+    "$SKETCH" </dev/null 2>&1)
+
+  if [ $? -ne 0 ]; then
+    printf "%-14s %8s %8s %8s\n" "$name" "FAILED" "-" "-"
+    echo "$output" >&2
+    status=1
+    continue
+  fi
+
+  flash=$(echo "$output" | sed -n 's/^Sketch uses \([0-9]*\) bytes.*/\1/p')
+  ram=$(echo "$output" | sed -n 's/^Global variables use \([0-9]*\) bytes.*/\1/p')
+  heap=
+  if [ -n "$PORT" ]; then
+    heap=$(read_heap "$build") || heap=
+  fi
+  printf "%-14s %8s %8s %8s\n" "$name" "${flash:--}" "${ram:--}" "${heap:--}"
+done <<EOF_PROFILES
+$PROFILES
+EOF_PROFILES
+
+exit $status
@@ -57,29 +57,44 @@ Thank you for using the BlendixSerial library! This library was created to
  * allocates arrays for coordinates and received data, and sets up the text buffer.
  */
 blendixserial::blendixserial()
-    : numSets(1),            // Default to 1 transmit set
-      receiveSets(0),        // Default to 0 receive sets
-      textBufferSize(BLENDIX_TEXT_BUFFER_SIZE),
-      coordinates(nullptr),
+    : coordinates(nullptr),
       coordType(INT_TYPE),
+      numSets(BLENDIX_TX_ENABLED ? 1 : 0),  // Default to 1 transmit set (none without Tx)
       text(nullptr),
+      textBufferSize(0),
+      receiveSets(0),                       // Default to 0 receive sets
       receivedCoordinates(nullptr),
-      receivedSets(0)
+      receivedSets(0),
+      baudRate(0),                          // No rate has been negotiated yet
+      filters(nullptr),                     // Allocated by the first filter setter
+      filterSets(0),
+      oversample(1),                        // Default filter settings are a pass-through
+      medianWindow(1),
+      lowPassShift(0),
+      decimation(1)
 {
+#if BLENDIX_TX_ENABLED
   // Allocate memory for integer-based coordinates (up to BLENDIX_MAX_SETS)
   coordinates = new CoordinatesInt[BLENDIX_MAX_SETS];
 
-  // Allocate memory for the receivedCoordinates array (always float-based)
-  receivedCoordinates = new ReceivedCoordinates[BLENDIX_MAX_SETS];
-
   // Initialize coordinate values to zero
   resetCoordinates();
 
+#if BLENDIX_TEXT_ENABLED
   // Allocate memory for the text buffer and set it to an empty string
+  textBufferSize = BLENDIX_TEXT_BUFFER_SIZE;
   text = new char[BLENDIX_TEXT_BUFFER_SIZE];
   text[0] = '\0';
+#endif
+#endif
+
+#if BLENDIX_RX_ENABLED
+  // Allocate memory for the receivedCoordinates array (always float-based)
+  receivedCoordinates = new ReceivedCoordinates[BLENDIX_MAX_SETS];
+#endif
 }
 
+#if BLENDIX_TX_ENABLED
 /**
  * @brief setCoordinateTypeInternal
  * Internal helper to switch between int or float coordinate storage.
@@ -101,12 +116,20 @@ bool blendixserial::setCoordinateTypeInternal(CoordinateType type) {
     // Allocate a new array based on the updated type
     if (coordType == INT_TYPE) {
       coordinates = new CoordinatesInt[BLENDIX_MAX_SETS];
-    } else {
+    }
+#if BLENDIX_FLOAT_ENABLED
+    else {
       coordinates = new CoordinatesFloat[BLENDIX_MAX_SETS];
     }
+#endif
 
     // Reset all coordinate values to zero
     resetCoordinates();
+
+#if BLENDIX_FILTER_ENABLED
+    // Filter state is scaled differently for int and float, so start over
+    resetFilter();
+#endif
     return true;
   }
   return false; // No change needed
@@ -122,10 +145,13 @@ bool blendixserial::setCoordinateTypeInternal(CoordinateType type) {
 bool blendixserial::setCoordinateType(const char* type) {
   if (strcmp(type, COORD_TYPE_INT) == 0) {
     return setCoordinateTypeInternal(INT_TYPE);
-  } else if (strcmp(type, COORD_TYPE_FLOAT) == 0) {
+  }
+#if BLENDIX_FLOAT_ENABLED
+  else if (strcmp(type, COORD_TYPE_FLOAT) == 0) {
     return setCoordinateTypeInternal(FLOAT_TYPE);
   }
-  return false; // Invalid string
+#endif
+  return false; // Invalid string (or float support compiled out)
 }
 
 /**
@@ -145,9 +171,18 @@ bool blendixserial::setTxSets(int sets) {
     return false;
   }
   numSets = sets;
+
+#if BLENDIX_FILTER_ENABLED
+  // Resize the filter state to the new number of sets once it is in use
+  if (filters && !allocateFilter()) {
+    return false;
+  }
+#endif
   return true;
 }
+#endif
 
+#if BLENDIX_RX_ENABLED
 /**
  * @brief setRxSets
  * Sets how many coordinate sets will be received.
@@ -167,7 +202,9 @@ bool blendixserial::setRxSets(int sets) {
   receiveSets = sets;
   return true;
 }
+#endif
 
+#if BLENDIX_TX_ENABLED
 /**
  * @brief setCoordinates (int version)
  * Assigns integer x, y, z values to a specific transmit set (1-based index).
@@ -180,6 +217,19 @@ bool blendixserial::setCoordinates(int setNum, int xVal, int yVal, int zVal) {
   // Ensure the setNum is within range and we're using int-based coordinates
   if (setNum >= 1 && setNum <= numSets && coordType == INT_TYPE) {
     auto coords = static_cast<CoordinatesInt*>(coordinates);
+#if BLENDIX_FILTER_ENABLED
+    if (filterActive()) {
+      // Feed the raw sample through the filter; only store it when one emerges
+      int32_t in[3] = { xVal, yVal, zVal };
+      int32_t out[3];
+      if (filterSample(setNum - 1, in, out)) {
+        coords[setNum - 1].x = (int)out[0];
+        coords[setNum - 1].y = (int)out[1];
+        coords[setNum - 1].z = (int)out[2];
+      }
+      return true;
+    }
+#endif
     coords[setNum - 1].x = xVal;
     coords[setNum - 1].y = yVal;
     coords[setNum - 1].z = zVal;
@@ -188,6 +238,24 @@ bool blendixserial::setCoordinates(int setNum, int xVal, int yVal, int zVal) {
   return false;
 }
 
+#if BLENDIX_FLOAT_ENABLED
+#if BLENDIX_FILTER_ENABLED
+/**
+ * @brief floatToFixed
+ * Converts a float coordinate to the filter's fixed-point form, clamped to
+ * +-BLENDIX_FILTER_INPUT_MAX so the conversion itself cannot overflow.
+ *
+ * @param value The float coordinate.
+ * @return The value scaled by BLENDIX_FILTER_FLOAT_SCALE.
+ */
+static int32_t floatToFixed(float value) {
+  const float limit = BLENDIX_FILTER_INPUT_MAX / (float)BLENDIX_FILTER_FLOAT_SCALE;
+  if (value > limit) value = limit;
+  if (value < -limit) value = -limit;
+  return (int32_t)lround(value * BLENDIX_FILTER_FLOAT_SCALE);
+}
+#endif
+
 /**
  * @brief setCoordinates (float version)
  * Assigns floating-point x, y, z values to a specific transmit set (1-based index).
@@ -200,6 +268,19 @@ bool blendixserial::setCoordinates(int setNum, float xVal, float yVal, float zVa
   // Ensure the setNum is within range and we're using float-based coordinates
   if (setNum >= 1 && setNum <= numSets && coordType == FLOAT_TYPE) {
     auto coords = static_cast<CoordinatesFloat*>(coordinates);
+#if BLENDIX_FILTER_ENABLED
+    if (filterActive()) {
+      // Convert to fixed point so the filter runs on integer arithmetic
+      int32_t in[3] = { floatToFixed(xVal), floatToFixed(yVal), floatToFixed(zVal) };
+      int32_t out[3];
+      if (filterSample(setNum - 1, in, out)) {
+        coords[setNum - 1].x = out[0] / (float)BLENDIX_FILTER_FLOAT_SCALE;
+        coords[setNum - 1].y = out[1] / (float)BLENDIX_FILTER_FLOAT_SCALE;
+        coords[setNum - 1].z = out[2] / (float)BLENDIX_FILTER_FLOAT_SCALE;
+      }
+      return true;
+    }
+#endif
     coords[setNum - 1].x = xVal;
     coords[setNum - 1].y = yVal;
     coords[setNum - 1].z = zVal;
@@ -207,6 +288,7 @@ bool blendixserial::setCoordinates(int setNum, float xVal, float yVal, float zVa
   }
   return false;
 }
+#endif
 
 /**
  * @brief resetCoordinates
@@ -221,7 +303,9 @@ void blendixserial::resetCoordinates() {
       coords[i].y = 0;
       coords[i].z = 0;
     }
-  } else {
+  }
+#if BLENDIX_FLOAT_ENABLED
+  else {
     // Cast to float array
     auto coords = static_cast<CoordinatesFloat*>(coordinates);
     for (int i = 0; i < numSets; i++) {
@@ -230,8 +314,10 @@ void blendixserial::resetCoordinates() {
       coords[i].z = 0.0f;
     }
   }
+#endif
 }
 
+#if BLENDIX_TEXT_ENABLED
 /**
  * @brief setText
  * Copies a user-supplied string into the text buffer for optional usage in formatted output.
@@ -244,6 +330,7 @@ void blendixserial::setText(const char* inputText) {
     text[textBufferSize - 1] = '\0'; // Ensure null termination
   }
 }
+#endif
 
 /**
  * @brief getFormattedOutput
@@ -286,7 +373,9 @@ void blendixserial::getFormattedOutput(uint8_t* outputBuffer, size_t bufferSize)
         outputBuffer[offset++] = ',';
       }
     }
-  } else {
+  }
+#if BLENDIX_FLOAT_ENABLED
+  else {
     // Cast the coordinates pointer to float-based structure
     auto coords = static_cast<CoordinatesFloat*>(coordinates);
     for (int i = 0; i < numSets; i++) {
@@ -308,18 +397,261 @@ void blendixserial::getFormattedOutput(uint8_t* outputBuffer, size_t bufferSize)
       }
     }
   }
+#endif
 
   // Append semicolon and text at the end, if there's space
   if (offset < bufferSize - 1) {
+#if BLENDIX_TEXT_ENABLED
     snprintf((char*)outputBuffer + offset, bufferSize - offset, ";%s", text ? text : "");
+#else
+    snprintf((char*)outputBuffer + offset, bufferSize - offset, ";");
+#endif
   }
 
   // Clean up
   delete[] tempBuffer;
   // Ensure the output is null-terminated
   outputBuffer[bufferSize - 1] = '\0';
+
+#if BLENDIX_FILTER_ENABLED
+  // The current values have been consumed; wait for the next decimated output
+  if (filters) {
+    for (int i = 0; i < filterSets; i++) {
+      filters[i].ready = false;
+    }
+  }
+#endif
+}
+
+#if BLENDIX_FILTER_ENABLED
+/**
+ * @brief medianOf
+ * Returns the median of the first `count` values without modifying them.
+ * Uses an insertion sort on a local copy, which is cheap for small windows.
+ *
+ * @param values The values to inspect.
+ * @param count How many values are valid (1 to BLENDIX_FILTER_MEDIAN_MAX).
+ * @return The middle value after sorting.
+ */
+static int32_t medianOf(const int32_t* values, uint8_t count) {
+  int32_t sorted[BLENDIX_FILTER_MEDIAN_MAX];
+  for (uint8_t i = 0; i < count; i++) {
+    int32_t v = values[i];
+    uint8_t j = i;
+    while (j > 0 && sorted[j - 1] > v) {
+      sorted[j] = sorted[j - 1];
+      j--;
+    }
+    sorted[j] = v;
+  }
+  // While the window is still filling the count may be even; average the middle pair
+  if (count % 2 == 0) {
+    return (sorted[count / 2 - 1] + sorted[count / 2]) / 2;
+  }
+  return sorted[count / 2];
+}
+
+/**
+ * @brief filterSample
+ * Runs one raw sample through the pipeline of a transmit set:
+ * oversample/average -> median-of-N -> single-pole low-pass -> decimation.
+ * All stages use integer arithmetic on fixed per-set state. Inputs are clamped
+ * to +-BLENDIX_FILTER_INPUT_MAX so the sums and the 24.8 low-pass cannot overflow.
+ *
+ * @param setIndex The zero-based transmit set index.
+ * @param in The raw x, y, z sample.
+ * @param out Receives the filtered x, y, z values when an output is emitted.
+ * @return true if a new output was produced, false otherwise.
+ */
+bool blendixserial::filterSample(int setIndex, const int32_t in[3], int32_t out[3]) {
+  SetFilter& f = filters[setIndex];
+
+  // Oversampling: accumulate until we have enough samples to average
+  for (int a = 0; a < 3; a++) {
+    int32_t v = in[a];
+    if (v > BLENDIX_FILTER_INPUT_MAX) v = BLENDIX_FILTER_INPUT_MAX;
+    if (v < -BLENDIX_FILTER_INPUT_MAX) v = -BLENDIX_FILTER_INPUT_MAX;
+    f.axis[a].sum += v;
+  }
+  if (++f.sampleCount < oversample) {
+    return false;
+  }
+  f.sampleCount = 0;
+
+  for (int a = 0; a < 3; a++) {
+    AxisFilter& axis = f.axis[a];
+
+    // Rounded average of the accumulated samples
+    int32_t sum = axis.sum;
+    int32_t avg = (sum >= 0 ? sum + oversample / 2 : sum - oversample / 2) / oversample;
+    axis.sum = 0;
+
+    // Median-of-N: store the average, then take the median of the window
+    axis.window[f.windowIndex] = avg;
+    uint8_t fill = (f.windowFill < medianWindow) ? f.windowFill + 1 : medianWindow;
+    int32_t med = medianOf(axis.window, fill);
+
+    // Single-pole low-pass in 24.8 fixed point, seeded with the first sample
+    int32_t target = med * 256;
+    if (!f.primed) {
+      axis.lowPass = target;
+    } else {
+      axis.lowPass += (target - axis.lowPass) >> lowPassShift;
+    }
+    out[a] = (axis.lowPass + 128) >> 8;
+  }
+
+  // Advance the median window shared by the three axes
+  f.windowIndex = (f.windowIndex + 1) % medianWindow;
+  if (f.windowFill < medianWindow) {
+    f.windowFill++;
+  }
+  f.primed = true;
+
+  // Decimation: only emit every Nth filtered sample
+  if (++f.decimCount < decimation) {
+    return false;
+  }
+  f.decimCount = 0;
+  f.ready = true;
+  return true;
+}
+
+/**
+ * @brief setOversampling
+ * Sets how many raw samples are averaged before entering the median stage.
+ *
+ * @param samples Number of samples to average (at least 1).
+ * @return true if valid and updated, false otherwise.
+ */
+bool blendixserial::setOversampling(uint8_t samples) {
+  if (samples < 1 || !allocateFilter()) {
+    return false;
+  }
+  oversample = samples;
+  resetFilter();
+  return true;
+}
+
+/**
+ * @brief setMedianWindow
+ * Sets the size of the median-of-N window.
+ *
+ * @param size Window size, 1 to BLENDIX_FILTER_MEDIAN_MAX.
+ * @return true if valid and updated, false otherwise.
+ */
+bool blendixserial::setMedianWindow(uint8_t size) {
+  if (size < 1 || size > BLENDIX_FILTER_MEDIAN_MAX || !allocateFilter()) {
+    return false;
+  }
+  medianWindow = size;
+  resetFilter();
+  return true;
+}
+
+/**
+ * @brief setLowPass
+ * Sets the low-pass smoothing shift. Larger values smooth more but respond slower.
+ *
+ * @param shift Smoothing shift, 0 to 8.
+ * @return true if valid and updated, false otherwise.
+ */
+bool blendixserial::setLowPass(uint8_t shift) {
+  if (shift > 8 || !allocateFilter()) {
+    return false;
+  }
+  lowPassShift = shift;
+  resetFilter();
+  return true;
+}
+
+/**
+ * @brief setDecimation
+ * Sets how many filtered samples make up one emitted output.
+ *
+ * @param factor Decimation factor (at least 1).
+ * @return true if valid and updated, false otherwise.
+ */
+bool blendixserial::setDecimation(uint8_t factor) {
+  if (factor < 1 || !allocateFilter()) {
+    return false;
+  }
+  decimation = factor;
+  resetFilter();
+  return true;
+}
+
+/**
+ * @brief resetFilter
+ * Clears accumulators, median windows, low-pass state and counters for all sets.
+ */
+void blendixserial::resetFilter() {
+  if (filters) {
+    memset(filters, 0, sizeof(SetFilter) * filterSets);
+  }
+}
+
+/**
+ * @brief allocateFilter
+ * Allocates filter state for the configured transmit sets the first time a
+ * filter is configured, and again whenever setTxSets() changes the count.
+ * Sketches that never filter do not pay for it in RAM. At least one set is
+ * allocated so a non-null `filters` always means the filter is in use.
+ *
+ * @return true if the state is available, false if allocation failed.
+ */
+bool blendixserial::allocateFilter() {
+  int sets = (numSets > 0) ? numSets : 1;
+  if (filters && filterSets == sets) {
+    return true;
+  }
+
+  delete[] filters;
+  filterSets = 0;
+  filters = new SetFilter[sets];
+  if (!filters) {
+    return false;
+  }
+  filterSets = sets;
+  resetFilter();
+  return true;
+}
+
+/**
+ * @brief filterActive
+ * Checks whether the pipeline is allocated and any stage does real work.
+ * With pass-through settings samples are stored unchanged.
+ *
+ * @return true if samples must be filtered, false otherwise.
+ */
+bool blendixserial::filterActive() const {
+  return filters &&
+         (oversample > 1 || medianWindow > 1 || lowPassShift > 0 || decimation > 1);
 }
 
+/**
+ * @brief isOutputReady
+ * Checks whether every transmit set has emitted a new filtered value
+ * since the last call to getFormattedOutput().
+ *
+ * @return true if a new frame is ready to send, false otherwise.
+ */
+bool blendixserial::isOutputReady() const {
+  // A pass-through filter has a fresh value after every setCoordinates()
+  if (!filterActive()) {
+    return true;
+  }
+  for (int i = 0; i < numSets; i++) {
+    if (!filters[i].ready) {
+      return false;
+    }
+  }
+  return true;
+}
+#endif
+#endif
+
+#if BLENDIX_RX_ENABLED
 /**
  * @brief validateAndParseData
  * Internal helper to tokenize the incoming data string by commas and semicolons,
@@ -398,10 +730,20 @@ bool blendixserial::validateAndParseData(const char* inputData, ReceivedCoordina
  */
 bool blendixserial::parseReceivedData(const String& inputData) {
   // Convert Arduino String to C-style string
-  const char* inputCStr = inputData.c_str();
+  return parseReceivedData(inputData.c_str());
+}
 
+/**
+ * @brief parseReceivedData (C-string version)
+ * Does the actual work for both overloads, so sketches can pass a char buffer
+ * directly and avoid pulling in the String class.
+ *
+ * @param inputCStr The incoming null-terminated data string.
+ * @return true if parsing was successful, false otherwise.
+ */
+bool blendixserial::parseReceivedData(const char* inputCStr) {
   // We expect the data to end with a semicolon
-  if (inputCStr == nullptr || inputCStr[strlen(inputCStr) - 1] != ';') {
+  if (inputCStr == nullptr || inputCStr[0] == '\0' || inputCStr[strlen(inputCStr) - 1] != ';') {
     return false;
   }
 
@@ -450,3 +792,166 @@ bool blendixserial::getReceivedCoordinates(int index, float& x, float& y, float&
   z = receivedCoordinates[index].z;
   return true;
 }
+#endif
+
+#if BLENDIX_BAUD_ENABLED
+/**
+ * @brief readControlFrame
+ * Reads characters until a complete "@...;" frame has arrived or the timeout expires.
+ *
+ * @param port The stream to read from.
+ * @param frame Buffer that receives the null-terminated frame.
+ * @param frameSize The size of the frame buffer.
+ * @param timeoutMs Maximum time to wait, in milliseconds.
+ * @return true if a complete frame was read, false otherwise.
+ */
+bool blendixserial::readControlFrame(Stream& port, char* frame, size_t frameSize, unsigned long timeoutMs) {
+  size_t length = 0;
+  unsigned long start = millis();
+
+  while (millis() - start < timeoutMs) {
+    if (!port.available()) {
+      // Let cooperative cores (e.g. ESP8266) run their background tasks
+      yield();
+      continue;
+    }
+    char c = port.read();
+
+    // Skip everything until the start of a frame
+    if (length == 0 && c != '@') {
+      continue;
+    }
+
+    // Leave room for the null terminator; an oversized frame is invalid
+    if (length >= frameSize - 1) {
+      return false;
+    }
+    frame[length++] = c;
+
+    // A semicolon completes the frame
+    if (c == ';') {
+      frame[length] = '\0';
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief drainInput
+ * Discards everything waiting in the receive buffer, e.g. bytes that were
+ * received at the wrong rate around a baud switch.
+ *
+ * @param port The stream to drain.
+ */
+static void drainInput(Stream& port) {
+  while (port.available()) {
+    port.read();
+  }
+}
+
+/**
+ * @brief negotiateBaudInternal
+ * Offers the supported rates, switches to the one chosen by the host and
+ * verifies the new link with a probe and a confirmation. If verification
+ * fails, returns to safeBaud, waits for the host to fall back as well and
+ * offers again, up to BLENDIX_BAUD_ATTEMPTS times.
+ *
+ * @param port The stream to negotiate on.
+ * @param portHandle The concrete port, passed back to switchBaud.
+ * @param switchBaud Callback that restarts the port at a new rate.
+ * @param rates Supported baud rates, fastest first.
+ * @param numRates Number of entries in rates.
+ * @param safeBaud The rate both sides start and fall back at.
+ * @param timeoutMs How long to wait for each host reply, in milliseconds.
+ * @return true if running at the negotiated rate, false if back on safeBaud.
+ */
+bool blendixserial::negotiateBaudInternal(Stream& port, void* portHandle, BaudSwitch switchBaud,
+                                          const unsigned long* rates, uint8_t numRates,
+                                          unsigned long safeBaud, unsigned long timeoutMs) {
+  baudRate = safeBaud;
+  if (!rates || numRates == 0) {
+    return false;
+  }
+
+  char frame[BLENDIX_CONTROL_FRAME_SIZE];
+  size_t prefixLength = strlen(BLENDIX_BAUD_SELECT);
+
+  for (uint8_t attempt = 0; attempt < BLENDIX_BAUD_ATTEMPTS; attempt++) {
+    // Offer our supported rates, e.g. "@BAUD:2000000,115200;"
+    port.print(BLENDIX_BAUD_OFFER);
+    for (uint8_t i = 0; i < numRates; i++) {
+      port.print(rates[i]);
+      if (i < numRates - 1) {
+        port.print(',');
+      }
+    }
+    port.println(';');
+
+    // Wait for the host to pick one, e.g. "@BAUD=2000000;". No answer at the
+    // safe rate means the host does not negotiate, so there is no point retrying.
+    if (!readControlFrame(port, frame, sizeof(frame), timeoutMs)) {
+      return false;
+    }
+    if (strncmp(frame, BLENDIX_BAUD_SELECT, prefixLength) != 0) {
+      return false;
+    }
+    unsigned long chosen = strtoul(frame + prefixLength, nullptr, 10);
+
+    // Only accept a rate we actually offered
+    bool supported = false;
+    for (uint8_t i = 0; i < numRates; i++) {
+      if (rates[i] == chosen) {
+        supported = true;
+        break;
+      }
+    }
+    if (!supported) {
+      return false;
+    }
+
+    // Acknowledge, let the acknowledgement drain, then switch
+    port.print(BLENDIX_BAUD_SELECT);
+    port.print(chosen);
+    port.println(';');
+    if (chosen != safeBaud) {
+      switchBaud(portHandle, chosen);
+    }
+
+    // Verify the new link: the host sends a probe, we answer it, and the host
+    // confirms it got the answer. Then announce the commit so the host sees
+    // traffic at the new rate even if the sketch is quiet.
+    if (readControlFrame(port, frame, sizeof(frame), timeoutMs) && strcmp(frame, BLENDIX_PROBE) == 0) {
+      port.println(BLENDIX_PROBE_REPLY);
+      if (readControlFrame(port, frame, sizeof(frame), timeoutMs) && strcmp(frame, BLENDIX_PROBE_CONFIRM) == 0) {
+        port.println(BLENDIX_LINK_UP);
+        baudRate = chosen;
+        return true;
+      }
+    }
+
+    // Verification failed: return to the safe rate and give the host time to
+    // do the same, discarding anything received at the wrong rate meanwhile
+    if (chosen != safeBaud) {
+      switchBaud(portHandle, safeBaud);
+    }
+    unsigned long start = millis();
+    while (millis() - start < BLENDIX_BAUD_LINK_TIMEOUT_MS) {
+      drainInput(port);
+      yield();
+    }
+    drainInput(port);
+  }
+  return false;
+}
+
+/**
+ * @brief getBaudRate
+ * Returns the baud rate in use after the last negotiation.
+ *
+ * @return The active baud rate, or 0 if negotiateBaud() has not run.
+ */
+unsigned long blendixserial::getBaudRate() const {
+  return baudRate;
+}
+#endif
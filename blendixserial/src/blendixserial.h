@@ -56,6 +56,11 @@ Thank you for using the BlendixSerial library! This library was created to
 
 #include <Arduino.h>
 
+// NOTE: The BLENDIX_* settings below are read when the library itself is compiled.
+// Change them as global build flags (e.g. compiler.cpp.extra_flags); a #define in
+// the sketch does not reach the library. They never change the object layout, so
+// a mismatch can at most hide functions (a compile or link error).
+
 // If not already defined, set a default maximum number of coordinate sets
 #ifndef BLENDIX_MAX_SETS
 #define BLENDIX_MAX_SETS 5
@@ -66,10 +71,101 @@ Thank you for using the BlendixSerial library! This library was created to
 #define BLENDIX_TEXT_BUFFER_SIZE 50
 #endif
 
+// Feature switches: define any of these as 0 to compile that subsystem out.
+// Transmit path: setTxSets(), setCoordinates(), getFormattedOutput()
+#ifndef BLENDIX_TX_ENABLED
+#define BLENDIX_TX_ENABLED 1
+#endif
+
+// Receive path: setRxSets(), parseReceivedData(), getReceived*() (pulls in strtok/atof)
+#ifndef BLENDIX_RX_ENABLED
+#define BLENDIX_RX_ENABLED 1
+#endif
+
+// Float transmit coordinates (pulls in dtostrf and float formatting)
+#ifndef BLENDIX_FLOAT_ENABLED
+#define BLENDIX_FLOAT_ENABLED 1
+#endif
+
+// Optional text message appended to transmitted frames
+#ifndef BLENDIX_TEXT_ENABLED
+#define BLENDIX_TEXT_ENABLED 1
+#endif
+
+// Baud-rate negotiation handshake: negotiateBaud(), getBaudRate()
+#ifndef BLENDIX_BAUD_ENABLED
+#define BLENDIX_BAUD_ENABLED 1
+#endif
+
+// If not already defined, enable the per-axis transmit filter pipeline
+#ifndef BLENDIX_FILTER_ENABLED
+#define BLENDIX_FILTER_ENABLED BLENDIX_TX_ENABLED
+#endif
+
+#if BLENDIX_FILTER_ENABLED && !BLENDIX_TX_ENABLED
+#error "BLENDIX_FILTER_ENABLED requires BLENDIX_TX_ENABLED"
+#endif
+
+// If not already defined, set the largest median window the filter can hold
+#ifndef BLENDIX_FILTER_MEDIAN_MAX
+#define BLENDIX_FILTER_MEDIAN_MAX 5
+#endif
+
+// Fixed-point scale used when filtering float coordinates (100 = 2 decimal places)
+#ifndef BLENDIX_FILTER_FLOAT_SCALE
+#define BLENDIX_FILTER_FLOAT_SCALE 100
+#endif
+
+// Largest magnitude the active filter accepts; larger inputs are clamped.
+// For float coordinates the limit is BLENDIX_FILTER_INPUT_MAX / BLENDIX_FILTER_FLOAT_SCALE
+// (+-41943.03 by default). A pass-through filter does not clamp.
+#define BLENDIX_FILTER_INPUT_MAX 4194303L
+
 // String constants for coordinate type selection
 #define COORD_TYPE_INT "int"
 #define COORD_TYPE_FLOAT "float"
 
+// Control frames used by negotiateBaud(). They start with '@' so they can never
+// be mistaken for coordinate data. Each frame is sent on its own line.
+//   Device -> Host (safe rate): "@BAUD:2000000,1000000,115200;"  supported rates
+//   Host -> Device (safe rate): "@BAUD=1000000;"                 chosen rate
+//   Device -> Host (safe rate): "@BAUD=1000000;"                 acknowledge, both switch
+//   Host -> Device (new rate):  "@PING;"                         probe
+//   Device -> Host (new rate):  "@PONG;"                         probe reply
+//   Host -> Device (new rate):  "@OK;"                           host got the reply
+//   Device -> Host (new rate):  "@UP;"                           device committed
+//
+// Recovery rules:
+//   - Host: if "@PONG;" does not arrive in time, return to the safe rate. After
+//     sending "@OK;", return to the safe rate if no complete frame (control or
+//     coordinate data) arrives within BLENDIX_BAUD_LINK_TIMEOUT_MS. Then wait for
+//     a new "@BAUD:" offer.
+//   - Device: if "@PING;" or "@OK;" does not arrive in time, return to the safe
+//     rate, wait BLENDIX_BAUD_LINK_TIMEOUT_MS so the host has fallen back too, and
+//     send the offer again (up to BLENDIX_BAUD_ATTEMPTS offers in total).
+// So a lost "@OK;" costs one retry instead of the link. One case remains that
+// neither side can detect on its own. If the device has committed and then every
+// frame it sends at the new rate is lost, the host falls back but the device does
+// not. A sketch that also receives from the host can spot the silence and recover
+// with Serial.begin(safeBaud) followed by another negotiateBaud().
+#define BLENDIX_BAUD_OFFER "@BAUD:"
+#define BLENDIX_BAUD_SELECT "@BAUD="
+#define BLENDIX_PROBE "@PING;"
+#define BLENDIX_PROBE_REPLY "@PONG;"
+#define BLENDIX_PROBE_CONFIRM "@OK;"
+#define BLENDIX_LINK_UP "@UP;"
+
+// How long the host waits for traffic after committing to a new rate
+#define BLENDIX_BAUD_LINK_TIMEOUT_MS 1000
+
+// If not already defined, set how many offers negotiateBaud() makes before giving up
+#ifndef BLENDIX_BAUD_ATTEMPTS
+#define BLENDIX_BAUD_ATTEMPTS 3
+#endif
+
+// Size of the buffer used to read one incoming control frame
+#define BLENDIX_CONTROL_FRAME_SIZE 24
+
 /**
  * @class blendixserial
  * 
@@ -78,6 +174,10 @@ Thank you for using the BlendixSerial library! This library was created to
  */
 class blendixserial {
 private:
+  // The data members below are declared whatever the BLENDIX_*_ENABLED switches
+  // say, so a sketch and the library always agree on the object's size. The
+  // switches only remove code and the heap buffers that code would allocate.
+
   /**
    * CoordinateType
    * - Used internally to keep track of whether we're storing coordinates as int or float.
@@ -114,6 +214,30 @@ private:
     float z;
   };
 
+  /**
+   * AxisFilter
+   * - Filter state for one axis, kept in integer (fixed-point) form.
+   */
+  struct AxisFilter {
+    int32_t sum;                                // Oversampling accumulator
+    int32_t window[BLENDIX_FILTER_MEDIAN_MAX];  // Median ring buffer
+    int32_t lowPass;                            // IIR state, scaled by 2^8
+  };
+
+  /**
+   * SetFilter
+   * - Filter state for one transmit set (x, y, z) plus its stage counters.
+   */
+  struct SetFilter {
+    AxisFilter axis[3];
+    uint8_t sampleCount;   // Samples accumulated towards the current average
+    uint8_t windowFill;    // How many median slots hold valid data
+    uint8_t windowIndex;   // Next median slot to overwrite
+    uint8_t decimCount;    // Filtered samples since the last emitted one
+    bool primed;           // Low-pass state has been seeded
+    bool ready;            // A new decimated output is stored in `coordinates`
+  };
+
   // Pointer to an array of coordinate structures (either int or float), allocated at runtime
   void* coordinates;
 
@@ -138,6 +262,85 @@ private:
   // How many sets were actually received
   int receivedSets;
 
+  // Baud rate currently in use on the negotiated port (0 until negotiateBaud() runs)
+  unsigned long baudRate;
+
+  // Filter state for each transmit set, allocated by the first filter setter
+  SetFilter* filters;
+
+  // How many sets `filters` holds (follows setTxSets())
+  int filterSets;
+
+  // Filter configuration (defaults make the pipeline a pass-through)
+  uint8_t oversample;
+  uint8_t medianWindow;
+  uint8_t lowPassShift;
+  uint8_t decimation;
+
+#if BLENDIX_BAUD_ENABLED
+  /**
+   * @brief readControlFrame
+   * Internal helper that waits for one '@'-prefixed frame ending in ';'.
+   * Anything received before the '@' (line endings, noise) is skipped.
+   * 
+   * @param port The stream to read from.
+   * @param frame Buffer that receives the null-terminated frame.
+   * @param frameSize The size of the frame buffer.
+   * @param timeoutMs How long to wait for a complete frame, in milliseconds.
+   * @return true if a complete frame was read, false on timeout or overflow.
+   */
+  bool readControlFrame(Stream& port, char* frame, size_t frameSize, unsigned long timeoutMs);
+
+  /**
+   * BaudSwitch
+   * - Callback that flushes a port and restarts it at a new baud rate.
+   */
+  typedef void (*BaudSwitch)(void* port, unsigned long baud);
+
+  /**
+   * @brief negotiateBaudInternal
+   * Port-independent implementation of negotiateBaud(). Reads and writes through
+   * `stream` and calls `switchBaud(portHandle, rate)` to change the rate.
+   * 
+   * @return true if the port is now running at the negotiated rate, false otherwise.
+   */
+  bool negotiateBaudInternal(Stream& stream, void* portHandle, BaudSwitch switchBaud,
+                             const unsigned long* rates, uint8_t numRates,
+                             unsigned long safeBaud, unsigned long timeoutMs);
+#endif
+
+#if BLENDIX_FILTER_ENABLED
+  /**
+   * @brief filterSample
+   * Internal helper that runs one raw (x, y, z) sample through the oversample,
+   * median, low-pass and decimation stages of a set.
+   * 
+   * @param setIndex The zero-based transmit set index.
+   * @param in The raw sample as fixed-point values.
+   * @param out Receives the filtered values when a new output is emitted.
+   * @return true if a decimated output was produced, false otherwise.
+   */
+  bool filterSample(int setIndex, const int32_t in[3], int32_t out[3]);
+
+  /**
+   * @brief filterActive
+   * Internal helper that tells whether samples must go through the pipeline.
+   * 
+   * @return true if the filter state exists and any stage is configured, false otherwise.
+   */
+  bool filterActive() const;
+
+  /**
+   * @brief allocateFilter
+   * Internal helper that (re)allocates the filter state for the current number
+   * of transmit sets. Existing state is cleared.
+   * 
+   * @return true if the state is available, false if allocation failed.
+   */
+  bool allocateFilter();
+#endif
+
+#if BLENDIX_TX_ENABLED
   /**
    * @brief setCoordinateTypeInternal
    * Internal helper to switch between storing int or float coordinates.
@@ -148,7 +351,9 @@ private:
    * @return true if the type was changed, false if the type remains the same.
    */
   bool setCoordinateTypeInternal(CoordinateType type);
+#endif
 
+#if BLENDIX_RX_ENABLED
   /**
    * @brief validateAndParseData
    * Internal function to parse incoming data (in CSV-like format) into a temporary array
@@ -160,6 +365,7 @@ private:
    * @return true if parsing was successful, false otherwise.
    */
   bool validateAndParseData(const char* inputData, ReceivedCoordinates*& tempCoords, int& tempNumSets);
+#endif
 
 public:
   /**
@@ -168,6 +374,7 @@ public:
    */
   blendixserial();
 
+#if BLENDIX_TX_ENABLED
   /**
    * @brief setCoordinateType
    * Public function to switch coordinate storage type via string ("int" or "float").
@@ -189,6 +396,7 @@ public:
   /**
    * @brief setCoordinates (int version)
    * Stores integer coordinates for a specific set index (1-based).
+   * When the filter is enabled, the values are a raw sample fed into the pipeline.
    * 
    * @param setNum The index of the coordinate set (1-based).
    * @param xVal, yVal, zVal The integer coordinates to store.
@@ -196,15 +404,18 @@ public:
    */
   bool setCoordinates(int setNum, int xVal, int yVal, int zVal);
 
+#if BLENDIX_FLOAT_ENABLED
   /**
    * @brief setCoordinates (float version)
    * Stores float coordinates for a specific set index (1-based).
+   * When the filter is enabled, the values are a raw sample fed into the pipeline.
    * 
    * @param setNum The index of the coordinate set (1-based).
    * @param xVal, yVal, zVal The float coordinates to store.
    * @return true if successful, false otherwise.
    */
   bool setCoordinates(int setNum, float xVal, float yVal, float zVal);
+#endif
 
   /**
    * @brief resetCoordinates
@@ -212,6 +423,7 @@ public:
    */
   void resetCoordinates();
 
+#if BLENDIX_TEXT_ENABLED
   /**
    * @brief setText
    * Stores a C-style string into the text buffer.
@@ -219,17 +431,75 @@ public:
    * @param inputText The string to copy into the buffer.
    */
   void setText(const char* inputText);
+#endif
 
   /**
    * @brief getFormattedOutput
    * Formats the stored coordinates plus the text buffer into a single string.
-   * For example: "x,y,z,x,y,z;someText".
+   * For example: "x,y,z,x,y,z;someText" (just "x,y,z;" when text is compiled out).
    * 
    * @param outputBuffer The buffer to hold the formatted string (cast as uint8_t* for Arduino).
    * @param bufferSize The size of the output buffer.
    */
   void getFormattedOutput(uint8_t* outputBuffer, size_t bufferSize);
+#endif
+
+#if BLENDIX_FILTER_ENABLED
+  /**
+   * @brief setOversampling
+   * Sets how many raw samples are averaged into one filtered sample.
+   * 
+   * @param samples Number of samples to average (1 disables oversampling).
+   * @return true if successfully set, false otherwise.
+   */
+  bool setOversampling(uint8_t samples);
+
+  /**
+   * @brief setMedianWindow
+   * Sets the size of the median-of-N stage used to reject spikes.
+   * 
+   * @param size Window size, 1 to BLENDIX_FILTER_MEDIAN_MAX (1 disables the stage).
+   * @return true if successfully set, false otherwise.
+   */
+  bool setMedianWindow(uint8_t size);
+
+  /**
+   * @brief setLowPass
+   * Sets the single-pole low-pass strength: y += (x - y) / 2^shift.
+   * 
+   * @param shift Smoothing shift, 0 to 8 (0 disables the stage).
+   * @return true if successfully set, false otherwise.
+   */
+  bool setLowPass(uint8_t shift);
+
+  /**
+   * @brief setDecimation
+   * Emits only every Nth filtered sample. The output rate becomes the
+   * setCoordinates() call rate divided by (oversampling * decimation).
+   * 
+   * @param factor Decimation factor (1 disables decimation).
+   * @return true if successfully set, false otherwise.
+   */
+  bool setDecimation(uint8_t factor);
+
+  /**
+   * @brief resetFilter
+   * Clears all filter state so the next sample starts a fresh pipeline.
+   */
+  void resetFilter();
+
+  /**
+   * @brief isOutputReady
+   * Reports whether every transmit set has a new filtered value since the
+   * last call to getFormattedOutput(). Use it to decide when to send a frame.
+   * Always true while the filter is a pass-through.
+   * 
+   * @return true if a new frame is ready, false otherwise.
+   */
+  bool isOutputReady() const;
+#endif
 
+#if BLENDIX_RX_ENABLED
   /**
    * @brief setRxSets
    * Sets how many coordinate sets this library will receive (Rx).
@@ -249,6 +519,16 @@ public:
    */
   bool parseReceivedData(const String& inputData);
 
+  /**
+   * @brief parseReceivedData (C-string version)
+   * Same as above, but works on a plain C-style string so sketches that do not
+   * otherwise use the String class can avoid linking it.
+   * 
+   * @param inputData The incoming null-terminated data string.
+   * @return true if parsing was successful, false otherwise.
+   */
+  bool parseReceivedData(const char* inputData);
+
   /**
    * @brief getReceivedNumSets
    * Returns how many coordinate sets were actually parsed from the last received data.
@@ -266,6 +546,55 @@ public:
    * @return true if valid index, false otherwise.
    */
   bool getReceivedCoordinates(int index, float& x, float& y, float& z) const;
+#endif
+
+#if BLENDIX_BAUD_ENABLED
+  /**
+   * @brief negotiateBaud
+   * Runs the baud-rate handshake with the host. The port must already be running
+   * at `safeBaud`. The supported rates are offered to the host, the port switches
+   * to the rate it picks, and a probe exchange verifies the new link in both
+   * directions. If verification fails the port goes back to `safeBaud` and the
+   * offer is repeated (see the recovery rules above). Blocks for up to about
+   * BLENDIX_BAUD_ATTEMPTS * (3 * timeoutMs + BLENDIX_BAUD_LINK_TIMEOUT_MS).
+   * Works with any port that has flush(), end() and begin(baud): hardware UARTs,
+   * native USB (CDC) ports and software serial ports.
+   * 
+   * @param port The serial port to negotiate on (e.g. Serial).
+   * @param rates Supported baud rates, fastest first.
+   * @param numRates Number of entries in `rates`.
+   * @param safeBaud The rate both sides start (and fall back) at.
+   * @param timeoutMs How long to wait for each host reply, in milliseconds.
+   * @return true if the port is now running at the negotiated rate, false otherwise.
+   */
+  template <typename SerialPort>
+  bool negotiateBaud(SerialPort& port, const unsigned long* rates, uint8_t numRates,
+                     unsigned long safeBaud, unsigned long timeoutMs = 500) {
+    return negotiateBaudInternal(port, &port, switchPortBaud<SerialPort>,
+                                 rates, numRates, safeBaud, timeoutMs);
+  }
+
+  /**
+   * @brief getBaudRate
+   * Returns the baud rate selected by the last call to negotiateBaud().
+   * 
+   * @return The active baud rate, or 0 if negotiateBaud() has not run.
+   */
+  unsigned long getBaudRate() const;
+
+private:
+  /**
+   * @brief switchPortBaud
+   * BaudSwitch implementation for a concrete port type.
+   */
+  template <typename SerialPort>
+  static void switchPortBaud(void* port, unsigned long baud) {
+    SerialPort* serialPort = static_cast<SerialPort*>(port);
+    serialPort->flush();
+    serialPort->end();
+    serialPort->begin(baud);
+  }
+#endif
 };
 
 #endif